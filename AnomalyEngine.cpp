@@ -0,0 +1,87 @@
+#include "AnomalyEngine.h"
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+
+std::string anomalyToString(AnomalyFlag f) {
+    switch (f) {
+        case AnomalySpike: return "Abnormal Reading";
+        case AnomalyDrift: return "Sensor Drift";
+        case AnomalyStuck: return "Sensor Stuck";
+        case AnomalyRapidChange: return "Rapid Change";
+        case AnomalyNonFinite: return "Invalid Reading";
+        default: return "";
+    }
+}
+
+AnomalyEngine::AnomalyEngine() {
+    AnomalyLimits rpm;
+    rpm.stuckRun = 20; // a running engine never holds RPM exactly
+    rpm.maxDelta = 3000.0;
+    setLimits(ChannelRPM, rpm);
+
+    AnomalyLimits load;
+    load.maxDelta = 60.0;
+    setLimits(ChannelEngineLoad, load);
+
+    AnomalyLimits temp;
+    temp.maxDelta = 15.0;
+    setLimits(ChannelCoolantTemp, temp);
+}
+
+void AnomalyEngine::setLimits(ChannelId channel, const AnomalyLimits& limits) {
+    // InvalidChannel + 1 wraps to 0; large ids would size the table.
+    if (channel >= ChannelRegistry::instance().size()) {
+        throw std::invalid_argument("Anomaly limits for unregistered channel id " + std::to_string(channel));
+    }
+    if (channel >= limits_.size()) limits_.resize(channel + 1, defaults_);
+    limits_[channel] = limits;
+}
+
+const AnomalyLimits& AnomalyEngine::limits(ChannelId channel) const {
+    return channel < limits_.size() ? limits_[channel] : defaults_;
+}
+
+std::uint8_t AnomalyEngine::observe(ChannelStats& s, ChannelId channel,
+                                    std::optional<double> previous, double value) const {
+    const AnomalyLimits& lim = limits(channel);
+    std::uint8_t flags = AnomalyNone;
+
+    // One NaN or infinity folded into the EWMA would poison it for good.
+    if (!std::isfinite(value)) {
+        s.flags = AnomalyNonFinite;
+        return s.flags;
+    }
+
+    if (previous && std::isfinite(*previous)) {
+        double delta = std::fabs(value - *previous);
+        if (delta > lim.maxDelta) flags |= AnomalyRapidChange;
+        if (delta <= lim.stuckEpsilon) {
+            if (s.repeats < UINT16_MAX) ++s.repeats;
+        } else {
+            s.repeats = 0;
+        }
+        // repeats counts readings after the first, so the run is repeats + 1 long.
+        if (lim.stuckRun > 0 && s.repeats + 1u >= lim.stuckRun) flags |= AnomalyStuck;
+    }
+
+    if (s.count == 0) {
+        s.mean = value;
+        s.var = 0.0;
+    } else {
+        double diff = value - s.mean;
+        double sd = std::sqrt(s.var);
+        if (s.count >= lim.warmup && sd > lim.minStdDev) {
+            double z = diff / sd;
+            if (std::fabs(z) > lim.zThreshold) flags |= AnomalySpike;
+            s.cusumHigh = std::max(0.0, s.cusumHigh + z - lim.cusumSlack);
+            s.cusumLow  = std::max(0.0, s.cusumLow - z - lim.cusumSlack);
+            if (s.cusumHigh > lim.cusumLimit || s.cusumLow > lim.cusumLimit) flags |= AnomalyDrift;
+        }
+        s.mean += lim.alpha * diff;
+        s.var = (1.0 - lim.alpha) * (s.var + lim.alpha * diff * diff);
+    }
+    if (s.count < UINT32_MAX) ++s.count;
+    s.flags = flags;
+    return flags;
+}
@@ -0,0 +1,68 @@
+#ifndef ANOMALY_ENGINE_H
+#define ANOMALY_ENGINE_H
+
+#include "Channel.h"
+#include <cstdint>
+#include <limits>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Bit flags raised by the most recent reading on a channel.
+enum AnomalyFlag : std::uint8_t {
+    AnomalyNone        = 0,
+    AnomalySpike       = 1 << 0, // |z| above zThreshold
+    AnomalyDrift       = 1 << 1, // CUSUM of z left the [-h, h] band
+    AnomalyStuck       = 1 << 2, // same value repeated stuckRun times
+    AnomalyRapidChange = 1 << 3, // |value - previous| above maxDelta
+    AnomalyNonFinite   = 1 << 4, // NaN or infinity; kept out of the statistics
+    AnomalyLast        = AnomalyNonFinite,
+};
+
+// Alert text per flag, matching the style of the CarStatus alerts.
+std::string anomalyToString(AnomalyFlag f);
+
+struct AnomalyLimits {
+    double alpha = 0.05;        // EWMA weight of the newest reading
+    std::uint32_t warmup = 30;  // readings before z-scores are trusted
+    double zThreshold = 4.0;
+    double cusumSlack = 0.5;    // k: per-reading z allowance
+    double cusumLimit = 8.0;    // h
+    double minStdDev = 1e-9;    // below this z is not computed
+    std::uint32_t stuckRun = 0; // 0 disables the stuck-value detector
+    double stuckEpsilon = 0.0;
+    double maxDelta = std::numeric_limits<double>::infinity();
+};
+
+// Online state for one car/channel pair. Constant size, updated in O(1).
+struct ChannelStats {
+    double mean = 0.0;
+    double var = 0.0;
+    double cusumHigh = 0.0;
+    double cusumLow = 0.0;
+    std::uint32_t count = 0;
+    std::uint16_t repeats = 0;
+    std::uint8_t flags = AnomalyNone;
+};
+
+// Per-channel limits plus the update rule. Holds no per-car state, so one
+// engine serves the whole fleet.
+class AnomalyEngine {
+public:
+    AnomalyEngine(); // built-in channels get tuned defaults
+
+    // Throws std::invalid_argument for ids the registry never handed out.
+    void setLimits(ChannelId channel, const AnomalyLimits& limits);
+    const AnomalyLimits& limits(ChannelId channel) const;
+
+    // Folds value into stats and returns the flags it raised. previous is the
+    // channel's last reading, if any.
+    std::uint8_t observe(ChannelStats& stats, ChannelId channel,
+                         std::optional<double> previous, double value) const;
+
+private:
+    AnomalyLimits defaults_;
+    std::vector<AnomalyLimits> limits_; // indexed by ChannelId
+};
+
+#endif // ANOMALY_ENGINE_H
@@ -0,0 +1,40 @@
+#ifndef CACHE_LINE_H
+#define CACHE_LINE_H
+
+#include <cstddef>
+#include <limits>
+#include <new>
+#include <vector>
+
+// Alignment used to keep independently written state on separate lines.
+// std::hardware_destructive_interference_size is not available everywhere.
+constexpr std::size_t CacheLineSize = 64;
+
+// Allocates whole cache lines, so a buffer never shares a line with any
+// other allocation. Used for per-car state that is written on every reading.
+template <typename T>
+struct CacheAlignedAllocator {
+    using value_type = T;
+
+    CacheAlignedAllocator() = default;
+    template <typename U> CacheAlignedAllocator(const CacheAlignedAllocator<U>&) {}
+
+    T* allocate(std::size_t n) {
+        if (n > (std::numeric_limits<std::size_t>::max() - CacheLineSize) / sizeof(T)) {
+            throw std::bad_array_new_length();
+        }
+        std::size_t bytes = (n * sizeof(T) + CacheLineSize - 1) / CacheLineSize * CacheLineSize;
+        return static_cast<T*>(::operator new(bytes, std::align_val_t(CacheLineSize)));
+    }
+    void deallocate(T* p, std::size_t) {
+        ::operator delete(p, std::align_val_t(CacheLineSize));
+    }
+
+    template <typename U> bool operator==(const CacheAlignedAllocator<U>&) const { return true; }
+    template <typename U> bool operator!=(const CacheAlignedAllocator<U>&) const { return false; }
+};
+
+template <typename T>
+using CacheAlignedVector = std::vector<T, CacheAlignedAllocator<T>>;
+
+#endif // CACHE_LINE_H
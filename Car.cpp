@@ -1,26 +1,52 @@
 #include "Car.h"
+#include "ScoringModel.h"
 
-Car::Car(std::string id) : id_(std::move(id)) {}
+Car::Car(std::string id) : id_(std::move(id)), slots_(ChannelRegistry::instance().size()) {}
 
 const std::string& Car::getId() const { return id_; }
 
 void Car::addDiagnostic(const Diagnostic& d) {
-    switch (d.getType()) {
-        case DiagnosticType::RPM:        rpm_ = d.getValue(); break;
-        case DiagnosticType::EngineLoad: engineLoad_ = d.getValue(); break;
-        case DiagnosticType::CoolantTemp:coolantTemp_ = d.getValue(); break;
-        default: break;
+    if (d.getChannel() == InvalidChannel) return;
+    set(d.getChannel(), d.getValue());
+}
+
+void Car::set(ChannelId channel, double value) {
+    if (ChannelSlot* s = slot(channel)) {
+        s->value = value;
+        s->present = true;
     }
 }
 
+ChannelSlot* Car::slot(ChannelId channel) {
+    if (channel >= slots_.size()) {
+        size_t registered = ChannelRegistry::instance().size();
+        if (channel >= registered) return nullptr;
+        slots_.resize(registered);
+    }
+    return &slots_[channel];
+}
+
+void Car::clearAnomalyFlags() {
+    for (auto& s : slots_) s.stats.flags = AnomalyNone;
+}
+
+std::optional<double> Car::value(ChannelId channel) const {
+    if (!has(channel)) return std::nullopt;
+    return slots_[channel].value;
+}
+
 bool Car::hasAllRequired() const {
-    return rpm_.has_value() && engineLoad_.has_value() && coolantTemp_.has_value();
+    return hasAllRequired(ScoringModel::standard());
+}
+
+bool Car::hasAllRequired(const ScoringModel& model) const {
+    return model.hasAllRequired(*this);
 }
 
 std::optional<double> Car::computePerformanceScore() const {
-    if (!hasAllRequired()) return std::nullopt;
-    double rpmVal  = *rpm_;
-    double loadVal = *engineLoad_;
-    double tempVal = *coolantTemp_;
-    return 100.0 - (rpmVal / 100.0 + loadVal * 0.5 + (tempVal - 90.0) * 2.0);
+    return computePerformanceScore(ScoringModel::standard());
+}
+
+std::optional<double> Car::computePerformanceScore(const ScoringModel& model) const {
+    return model.score(*this);
 }
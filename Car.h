@@ -1,29 +1,56 @@
 #ifndef CAR_H
 #define CAR_H
 
+#include "AnomalyEngine.h"
+#include "CacheLine.h"
+#include "Channel.h"
 #include "Diagnostic.h"
 #include <optional>
 #include <string>
+#include <vector>
 
+class ScoringModel;
+
+// Everything one reading touches on one channel: the last value, whether
+// there is one, and the streaming statistics. One slot fills one cache line.
+struct alignas(CacheLineSize) ChannelSlot {
+    double value = 0.0;
+    ChannelStats stats;
+    bool present = false;
+};
+
+// Per-channel state lives in a single buffer of slots indexed by ChannelId,
+// so cars written by different threads never share a line.
 class Car {
 public:
     explicit Car(std::string id);
 
     const std::string& getId() const;
     void addDiagnostic(const Diagnostic& d);
+    void set(ChannelId channel, double value);
+
+    std::optional<double> value(ChannelId channel) const;
+    std::optional<double> rpm() const { return value(ChannelRPM); }
+    std::optional<double> engineLoad() const { return value(ChannelEngineLoad); }
+    std::optional<double> coolantTemp() const { return value(ChannelCoolantTemp); }
 
-    std::optional<double> rpm() const { return rpm_; }
-    std::optional<double> engineLoad() const { return engineLoad_; }
-    std::optional<double> coolantTemp() const { return coolantTemp_; }
+    bool has(ChannelId channel) const { return channel < slots_.size() && slots_[channel].present; }
+    // Slots for channels registered after this car was created are added on
+    // first use; nullptr for ids the registry never handed out.
+    ChannelSlot* slot(ChannelId channel);
+    const CacheAlignedVector<ChannelSlot>& slots() const { return slots_; }
+    void clearAnomalyFlags();
+    // Caller must have checked has(); no bounds or presence test.
+    double valueUnchecked(ChannelId channel) const { return slots_[channel].value; }
 
     bool hasAllRequired() const;
+    bool hasAllRequired(const ScoringModel& model) const;
     std::optional<double> computePerformanceScore() const;
+    std::optional<double> computePerformanceScore(const ScoringModel& model) const;
 
 private:
     std::string id_;
-    std::optional<double> rpm_;
-    std::optional<double> engineLoad_;
-    std::optional<double> coolantTemp_;
+    CacheAlignedVector<ChannelSlot> slots_; // one per registered channel
 };
 
 #endif // CAR_H
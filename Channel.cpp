@@ -0,0 +1,159 @@
+#include "Channel.h"
+#include <algorithm>
+#include <cctype>
+#include <numeric>
+#include <stdexcept>
+
+// Perfect hash in two levels ("hash and displace"): the name hash picks a
+// bucket, the bucket's seed remixes the hash into a slot that no other name
+// occupies. A lookup is one pass over the name plus a single probe.
+struct ChannelRegistry::Table {
+    std::vector<std::string> names;    // indexed by ChannelId
+    std::vector<std::uint64_t> hashes; // indexed by ChannelId
+    std::vector<std::uint32_t> seeds;  // per bucket
+    std::vector<ChannelId> slots;      // InvalidChannel when empty
+
+    void buildPerfectHash();
+};
+
+static std::string_view trimView(std::string_view s) {
+    size_t start = 0, end = s.size();
+    while (start < end && std::isspace(static_cast<unsigned char>(s[start]))) ++start;
+    while (end > start && std::isspace(static_cast<unsigned char>(s[end-1]))) --end;
+    return s.substr(start, end - start);
+}
+
+static unsigned char fold(char c) {
+    return static_cast<unsigned char>(std::toupper(static_cast<unsigned char>(c)));
+}
+
+// FNV-1a over the case-folded bytes.
+static std::uint64_t hashName(std::string_view s) {
+    std::uint64_t h = 14695981039346656037ull;
+    for (char c : s) {
+        h ^= fold(c);
+        h *= 1099511628211ull;
+    }
+    return h;
+}
+
+// splitmix64 finaliser, keyed by the bucket seed.
+static std::uint64_t remix(std::uint64_t h, std::uint32_t seed) {
+    h ^= std::uint64_t{seed} * 0x9E3779B97F4A7C15ull;
+    h = (h ^ (h >> 30)) * 0xBF58476D1CE4E5B9ull;
+    h = (h ^ (h >> 27)) * 0x94D049BB133111EBull;
+    return h ^ (h >> 31);
+}
+
+static bool equalsFolded(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (fold(a[i]) != fold(b[i])) return false;
+    }
+    return true;
+}
+
+static size_t nextPow2(size_t n) {
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+ChannelRegistry& ChannelRegistry::instance() {
+    static ChannelRegistry registry;
+    return registry;
+}
+
+ChannelRegistry::ChannelRegistry() {
+    registerChannel("RPM");
+    registerChannel("EngineLoad");
+    registerChannel("CoolantTemp");
+}
+
+ChannelRegistry::~ChannelRegistry() = default;
+
+ChannelId ChannelRegistry::registerChannel(std::string_view nameIn) {
+    std::string_view name = trimView(nameIn);
+    if (name.empty()) {
+        throw std::invalid_argument("Channel name must not be blank");
+    }
+
+    std::lock_guard<std::mutex> lock(writeMtx_);
+    ChannelId existing = find(name);
+    if (existing != InvalidChannel) return existing;
+
+    auto next = std::make_unique<Table>();
+    if (const Table* prev = table_.load(std::memory_order_relaxed)) {
+        next->names = prev->names;
+        next->hashes = prev->hashes;
+    }
+    next->names.emplace_back(name);
+    next->hashes.push_back(hashName(name));
+    next->buildPerfectHash();
+
+    ChannelId id = static_cast<ChannelId>(next->names.size() - 1);
+    table_.store(next.get(), std::memory_order_release);
+    tables_.push_back(std::move(next));
+    return id;
+}
+
+void ChannelRegistry::Table::buildPerfectHash() {
+    const size_t n = names.size();
+    const size_t slotCount = nextPow2(n * 2);
+    const size_t bucketCount = nextPow2(std::max<size_t>(1, n / 2));
+
+    std::vector<std::vector<ChannelId>> buckets(bucketCount);
+    for (ChannelId id = 0; id < n; ++id) {
+        buckets[hashes[id] & (bucketCount - 1)].push_back(id);
+    }
+    std::vector<size_t> order(bucketCount);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b){
+        return buckets[a].size() > buckets[b].size();
+    });
+
+    seeds.assign(bucketCount, 0);
+    slots.assign(slotCount, InvalidChannel);
+    std::vector<size_t> placed;
+    for (size_t b : order) {
+        if (buckets[b].empty()) break;
+        for (std::uint32_t seed = 0;; ++seed) {
+            placed.clear();
+            bool ok = true;
+            for (ChannelId id : buckets[b]) {
+                size_t slot = remix(hashes[id], seed) & (slotCount - 1);
+                if (slots[slot] != InvalidChannel ||
+                    std::find(placed.begin(), placed.end(), slot) != placed.end()) {
+                    ok = false;
+                    break;
+                }
+                placed.push_back(slot);
+            }
+            if (!ok) continue;
+            for (size_t i = 0; i < placed.size(); ++i) slots[placed[i]] = buckets[b][i];
+            seeds[b] = seed;
+            break;
+        }
+    }
+}
+
+ChannelId ChannelRegistry::find(std::string_view nameIn) const {
+    const Table* t = table_.load(std::memory_order_acquire);
+    if (!t) return InvalidChannel;
+    std::string_view name = trimView(nameIn);
+    std::uint64_t h = hashName(name);
+    std::uint32_t seed = t->seeds[h & (t->seeds.size() - 1)];
+    ChannelId id = t->slots[remix(h, seed) & (t->slots.size() - 1)];
+    if (id == InvalidChannel || t->hashes[id] != h || !equalsFolded(t->names[id], name)) {
+        return InvalidChannel;
+    }
+    return id;
+}
+
+const std::string& ChannelRegistry::name(ChannelId ch) const {
+    return current().names.at(ch);
+}
+
+size_t ChannelRegistry::size() const {
+    return current().names.size();
+}
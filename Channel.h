@@ -0,0 +1,51 @@
+#ifndef CHANNEL_H
+#define CHANNEL_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+// Dense index of a sensor channel. Ids are assigned in registration order
+// and never reused, so they can index per-car slot arrays directly.
+using ChannelId = std::uint32_t;
+constexpr ChannelId InvalidChannel = static_cast<ChannelId>(-1);
+
+// Fixed channels registered before anything else; their ids match the
+// DiagnosticType enumerators.
+constexpr ChannelId ChannelRPM         = 0;
+constexpr ChannelId ChannelEngineLoad  = 1;
+constexpr ChannelId ChannelCoolantTemp = 2;
+
+// Process-wide table of sensor channels. Names are matched case-insensitively
+// with surrounding whitespace ignored. Lookups go through a perfect hash and
+// never lock; registration rebuilds the table and publishes it atomically.
+class ChannelRegistry {
+public:
+    static ChannelRegistry& instance();
+
+    // Returns the existing id when the name is already registered.
+    // Throws std::invalid_argument on a blank name.
+    ChannelId registerChannel(std::string_view name);
+
+    ChannelId find(std::string_view name) const; // InvalidChannel if unknown
+    const std::string& name(ChannelId ch) const;  // throws std::out_of_range
+    size_t size() const;
+
+private:
+    struct Table;
+
+    ChannelRegistry();
+    ~ChannelRegistry();
+    const Table& current() const { return *table_.load(std::memory_order_acquire); }
+
+    std::mutex writeMtx_;
+    std::vector<std::unique_ptr<const Table>> tables_; // retired tables kept alive for readers
+    std::atomic<const Table*> table_{nullptr};
+};
+
+#endif // CHANNEL_H
@@ -1,25 +1,9 @@
 #include "Diagnostic.h"
-#include <algorithm>
-#include <cctype>
-
-static std::string trim(const std::string& s) {
-    size_t start = 0, end = s.size();
-    while (start < end && std::isspace(static_cast<unsigned char>(s[start]))) ++start;
-    while (end > start && std::isspace(static_cast<unsigned char>(s[end-1]))) --end;
-    return s.substr(start, end - start);
-}
-
-static std::string upper(std::string s) {
-    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c){ return std::toupper(c); });
-    return s;
-}
 
-DiagnosticType diagnosticTypeFromString(const std::string& sIn) {
-    std::string s = upper(trim(sIn));
-    if (s == "RPM") return DiagnosticType::RPM;
-    if (s == "ENGINELOAD") return DiagnosticType::EngineLoad;
-    if (s == "COOLANTTEMP") return DiagnosticType::CoolantTemp;
-    return DiagnosticType::Unknown;
+DiagnosticType diagnosticTypeFromString(const std::string& s) {
+    ChannelId ch = ChannelRegistry::instance().find(s);
+    if (ch > ChannelCoolantTemp) return DiagnosticType::Unknown;
+    return static_cast<DiagnosticType>(ch);
 }
 
 std::string diagnosticTypeToString(DiagnosticType t) {
@@ -31,9 +15,23 @@ std::string diagnosticTypeToString(DiagnosticType t) {
     }
 }
 
+ChannelId channelOf(DiagnosticType t) {
+    if (t == DiagnosticType::Unknown) return InvalidChannel;
+    return static_cast<ChannelId>(t);
+}
+
 Diagnostic::Diagnostic(std::string id, DiagnosticType type, double value)
-: id_(std::move(id)), type_(type), value_(value) {}
+: id_(std::move(id)), channel_(channelOf(type)), value_(value) {}
+
+Diagnostic::Diagnostic(std::string id, ChannelId channel, double value)
+: id_(std::move(id)), channel_(channel), value_(value) {}
 
 const std::string& Diagnostic::getId() const { return id_; }
-DiagnosticType Diagnostic::getType() const { return type_; }
+
+DiagnosticType Diagnostic::getType() const {
+    if (channel_ > ChannelCoolantTemp) return DiagnosticType::Unknown;
+    return static_cast<DiagnosticType>(channel_);
+}
+
+ChannelId Diagnostic::getChannel() const { return channel_; }
 double Diagnostic::getValue() const { return value_; }
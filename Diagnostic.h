@@ -1,29 +1,35 @@
 #ifndef DIAGNOSTIC_H
 #define DIAGNOSTIC_H
 
+#include "Channel.h"
 #include <string>
 
+// The original fixed sensors. Each enumerator's value is its ChannelId;
+// any other channel is reached through ChannelRegistry.
 enum class DiagnosticType {
-    RPM,
-    EngineLoad,
-    CoolantTemp,
+    RPM = ChannelRPM,
+    EngineLoad = ChannelEngineLoad,
+    CoolantTemp = ChannelCoolantTemp,
     Unknown
 };
 
 DiagnosticType diagnosticTypeFromString(const std::string& s);
 std::string diagnosticTypeToString(DiagnosticType t);
+ChannelId channelOf(DiagnosticType t); // InvalidChannel for Unknown
 
 class Diagnostic {
 public:
     Diagnostic(std::string id, DiagnosticType type, double value);
+    Diagnostic(std::string id, ChannelId channel, double value);
 
     const std::string& getId() const;
-    DiagnosticType getType() const;
+    DiagnosticType getType() const; // Unknown for registered (non-fixed) channels
+    ChannelId getChannel() const;
     double getValue() const;
 
 private:
     std::string id_;
-    DiagnosticType type_;
+    ChannelId channel_;
     double value_;
 };
 
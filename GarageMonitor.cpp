@@ -7,6 +7,7 @@
 #include <random>
 #include <cerrno>
 #include <cstdlib>
+#include <cmath>
 
 static std::string trim(const std::string& s) {
     size_t start = 0, end = s.size();
@@ -16,16 +17,36 @@ static std::string trim(const std::string& s) {
 }
 
 void GarageMonitor::addDiagnostic(const std::string& carId, DiagnosticType type, double value) {
+    addDiagnostic(carId, channelOf(type), value);
+}
+
+void GarageMonitor::addDiagnostic(const std::string& carId, ChannelId channel, double value) {
     std::lock_guard<std::mutex> lock(mtx_);
     auto it = cars_.find(carId);
     if (it == cars_.end()) {
         it = cars_.emplace(carId, Car(carId)).first;
     }
-    it->second.addDiagnostic(Diagnostic(carId, type, value));
-    DEBUG_LOG("Add " << carId << " " << diagnosticTypeToString(type) << "=" << value);
+    // Unregistered ids (InvalidChannel included) get no slot and are dropped.
+    ChannelSlot* slot = it->second.slot(channel);
+    if (!slot) return;
+    if (anomalyEnabled_) {
+        std::optional<double> previous;
+        if (slot->present) previous = slot->value;
+        anomaly_.observe(slot->stats, channel, previous, value);
+    }
+    slot->value = value;
+    slot->present = true;
+    DEBUG_LOG("Add " << carId << " " << ChannelRegistry::instance().name(channel) << "=" << value);
 }
 
 size_t GarageMonitor::loadCSV(std::istream& in, std::vector<std::string>& errors) {
+    return parseDiagnosticsCSV(in, errors, [this](const std::string& carId, ChannelId channel, double value){
+        addDiagnostic(carId, channel, value);
+    });
+}
+
+size_t parseDiagnosticsCSV(std::istream& in, std::vector<std::string>& errors,
+                           const DiagnosticSink& sink) {
     size_t count = 0;
     std::string line;
     size_t lineNo = 0;
@@ -54,8 +75,8 @@ size_t GarageMonitor::loadCSV(std::istream& in, std::vector<std::string>& errors
         typeStr  = trim(typeStr);
         valueStr = trim(valueStr);
 
-        DiagnosticType type = diagnosticTypeFromString(typeStr);
-        if (type == DiagnosticType::Unknown) {
+        ChannelId channel = ChannelRegistry::instance().find(typeStr);
+        if (channel == InvalidChannel) {
             errors.push_back("Line " + std::to_string(lineNo) + ": unknown Type '" + typeStr + "'");
             continue;
         }
@@ -68,7 +89,7 @@ size_t GarageMonitor::loadCSV(std::istream& in, std::vector<std::string>& errors
             continue;
         }
 
-        addDiagnostic(carId, type, val);
+        sink(carId, channel, val);
         ++count;
     }
     if (count == 0) {
@@ -79,16 +100,27 @@ size_t GarageMonitor::loadCSV(std::istream& in, std::vector<std::string>& errors
 
 CarStatus GarageMonitor::statusOfUnlocked(const Car& car) const {
     CarStatus st{};
-    st.hasAll = car.hasAllRequired();
+    std::string firstAnomaly;
+    const auto& slots = car.slots();
+    for (ChannelId ch = 0; anomalyEnabled_ && ch < slots.size(); ++ch) {
+        for (std::uint8_t bit = 1; bit <= AnomalyLast; bit <<= 1) {
+            if (!(slots[ch].stats.flags & bit)) continue;
+            std::string kind = anomalyToString(static_cast<AnomalyFlag>(bit));
+            if (firstAnomaly.empty()) firstAnomaly = kind;
+            st.anomalies.push_back(ChannelRegistry::instance().name(ch) + ": " + kind);
+        }
+    }
+
+    st.hasAll = car.hasAllRequired(model_);
     if (!st.hasAll) {
         st.alert = "Sensor Failure Detected";
         return st;
     }
-    st.score = car.computePerformanceScore();
+    st.score = car.computePerformanceScore(model_);
     if (st.score && *st.score < 40.0) {
         st.alert = "Severe Engine Stress";
     } else {
-        st.alert.clear();
+        st.alert = firstAnomaly;
     }
     return st;
 }
@@ -100,34 +132,58 @@ CarStatus GarageMonitor::statusOf(const std::string& carId) const {
     return statusOfUnlocked(it->second);
 }
 
+bool sameStatus(const CarStatus& a, const CarStatus& b) {
+    if (a.hasAll != b.hasAll || a.alert != b.alert || a.anomalies != b.anomalies) return false;
+    if (a.score.has_value() != b.score.has_value()) return false;
+    if (!a.score) return true;
+    return *a.score == *b.score || (std::isnan(*a.score) && std::isnan(*b.score));
+}
+
+void printStatusLine(std::ostream& out, const std::string& carId, const CarStatus& st) {
+    out << "Car: " << carId;
+    if (!st.hasAll) {
+        out << " | Status: " << st.alert << "\n";
+        return;
+    }
+    out << " | Score: " << *st.score;
+    if (!st.alert.empty()) out << " | Alert: " << st.alert;
+    if (!st.anomalies.empty()) {
+        out << " | Anomalies: ";
+        for (size_t i = 0; i < st.anomalies.size(); ++i) out << (i ? ", " : "") << st.anomalies[i];
+    }
+    out << "\n";
+}
+
 void GarageMonitor::printStatus(std::ostream& out) const {
     std::lock_guard<std::mutex> lock(mtx_);
     out << std::fixed << std::setprecision(2);
     for (const auto& [id, car] : cars_) {
-        CarStatus st = statusOfUnlocked(car);
-        out << "Car: " << id;
-        if (!st.hasAll) {
-            out << " | Status: " << st.alert << "\n";
-            continue;
-        }
-        out << " | Score: " << *st.score;
-        if (!st.alert.empty()) out << " | Alert: " << st.alert;
-        out << "\n";
+        printStatusLine(out, id, statusOfUnlocked(car));
     }
 }
 
-std::optional<double> GarageMonitor::averageScore() const {
+std::vector<std::pair<std::string, CarStatus>> GarageMonitor::statuses() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    std::vector<std::pair<std::string, CarStatus>> out;
+    out.reserve(cars_.size());
+    for (const auto& [id, car] : cars_) out.emplace_back(id, statusOfUnlocked(car));
+    return out;
+}
+
+ScoreTotals GarageMonitor::scoreTotals() const {
     std::lock_guard<std::mutex> lock(mtx_);
-    double sum = 0.0;
-    int n = 0;
+    ScoreTotals t;
     for (const auto& [id, car] : cars_) {
-        if (car.hasAllRequired()) {
-            auto s = car.computePerformanceScore();
-            if (s) { sum += *s; ++n; }
-        }
+        auto s = car.computePerformanceScore(model_);
+        if (s) { t.sum += *s; ++t.count; }
     }
-    if (n == 0) return std::nullopt;
-    return sum / n;
+    return t;
+}
+
+std::optional<double> GarageMonitor::averageScore() const {
+    ScoreTotals t = scoreTotals();
+    if (t.count == 0) return std::nullopt;
+    return t.sum / t.count;
 }
 
 bool GarageMonitor::hasCar(const std::string& id) const {
@@ -135,6 +191,36 @@ bool GarageMonitor::hasCar(const std::string& id) const {
     return cars_.find(id) != cars_.end();
 }
 
+void GarageMonitor::addCar(const std::string& id) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    if (cars_.find(id) == cars_.end()) cars_.emplace(id, Car(id));
+}
+
+size_t GarageMonitor::carCount() const {
+    std::lock_guard<std::mutex> lock(mtx_);
+    return cars_.size();
+}
+
+void GarageMonitor::setScoringModel(ScoringModel model) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    model_ = std::move(model);
+}
+
+void GarageMonitor::setAnomalyLimits(ChannelId channel, const AnomalyLimits& limits) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    anomaly_.setLimits(channel, limits);
+}
+
+void GarageMonitor::setAnomalyDetection(bool enabled) {
+    std::lock_guard<std::mutex> lock(mtx_);
+    // Flags from before the switch would otherwise be reported indefinitely,
+    // and resurface if detection is turned back on.
+    if (anomalyEnabled_ && !enabled) {
+        for (auto& [id, car] : cars_) car.clearAnomalyFlags();
+    }
+    anomalyEnabled_ = enabled;
+}
+
 // durationIterations: loop iterations per thread to simulate work
 // threadsPerRun: thread count when multithread==true, else ignored
 long long GarageMonitor::simulateRealTimeUpdates(
@@ -153,12 +239,11 @@ long long GarageMonitor::simulateRealTimeUpdates(
         }
     }
 
-    std::mt19937 rng(12345);
-    std::uniform_real_distribution<double> rpmDist(600.0, 7000.0);
-    std::uniform_real_distribution<double> loadDist(0.0, 100.0);
-    std::uniform_real_distribution<double> tempDist(70.0, 130.0);
-
-    auto updateOne = [&](const std::string& id){
+    // Each thread draws from its own generator; sharing one is a data race.
+    auto updateOne = [&](std::mt19937& rng, const std::string& id){
+        std::uniform_real_distribution<double> rpmDist(600.0, 7000.0);
+        std::uniform_real_distribution<double> loadDist(0.0, 100.0);
+        std::uniform_real_distribution<double> tempDist(70.0, 130.0);
         addDiagnostic(id, DiagnosticType::RPM, rpmDist(rng));
         addDiagnostic(id, DiagnosticType::EngineLoad, loadDist(rng));
         addDiagnostic(id, DiagnosticType::CoolantTemp, tempDist(rng));
@@ -173,21 +258,23 @@ long long GarageMonitor::simulateRealTimeUpdates(
         threads.reserve(threadsN);
         for (int t = 0; t < threadsN; ++t) {
             threads.emplace_back([&, t](){
+                std::mt19937 rng(12345 + t);
                 for (int i = 0; i < durationIterations; ++i) {
                     std::vector<std::string> ids;
                     { std::lock_guard<std::mutex> lock(mtx_);
                       for (auto& kv : cars_) ids.push_back(kv.first); }
-                    for (auto& id : ids) updateOne(id);
+                    for (auto& id : ids) updateOne(rng, id);
                 }
             });
         }
         for (auto& th : threads) th.join();
     } else {
+        std::mt19937 rng(12345);
         for (int i = 0; i < durationIterations; ++i) {
             std::vector<std::string> ids;
             { std::lock_guard<std::mutex> lock(mtx_);
               for (auto& kv : cars_) ids.push_back(kv.first); }
-            for (auto& id : ids) updateOne(id);
+            for (auto& id : ids) updateOne(rng, id);
         }
     }
 
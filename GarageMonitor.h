@@ -1,7 +1,9 @@
 #ifndef GARAGE_MONITOR_H
 #define GARAGE_MONITOR_H
 
+#include "AnomalyEngine.h"
 #include "Car.h"
+#include "ScoringModel.h"
 #include <map>
 #include <mutex>
 #include <string>
@@ -10,6 +12,7 @@
 #include <ostream>
 #include <optional>
 #include <chrono>
+#include <functional>
 
 // Simple debug macro: enable with -DDEBUG_LOGGING
 #ifdef DEBUG_LOGGING
@@ -22,12 +25,33 @@
 struct CarStatus {
     bool hasAll = false;
     std::optional<double> score;
-    std::string alert; // "" | "Sensor Failure Detected" | "Severe Engine Stress"
+    std::string alert; // "" | "Sensor Failure Detected" | "Severe Engine Stress" | first anomaly
+    std::vector<std::string> anomalies; // "<channel>: <anomaly>" raised by the latest readings
 };
 
+// Field-by-field equality; NaN scores compare equal so that identical
+// computations on NaN input still match.
+bool sameStatus(const CarStatus& a, const CarStatus& b);
+
+struct ScoreTotals {
+    double sum = 0.0;
+    size_t count = 0; // cars with a score
+};
+
+using DiagnosticSink = std::function<void(const std::string& carId, ChannelId channel, double value)>;
+
+// Parses "CarId, Type, Value" rows, recording bad rows in errors and passing
+// good ones to sink. Returns the number of good rows; throws on none.
+size_t parseDiagnosticsCSV(std::istream& in, std::vector<std::string>& errors,
+                           const DiagnosticSink& sink);
+
+// One "Car: ..." line as printed by printStatus.
+void printStatusLine(std::ostream& out, const std::string& carId, const CarStatus& st);
+
 class GarageMonitor {
 public:
     void addDiagnostic(const std::string& carId, DiagnosticType type, double value);
+    void addDiagnostic(const std::string& carId, ChannelId channel, double value);
     size_t loadCSV(std::istream& in, std::vector<std::string>& errors); // throws on empty CSV
 
     CarStatus statusOf(const std::string& carId) const;
@@ -35,11 +59,26 @@ public:
     std::optional<double> averageScore() const;
     long long simulateRealTimeUpdates(int durationIterations, int threadsPerRun, bool multithread);
     bool hasCar(const std::string& id) const;
+    void addCar(const std::string& id); // no-op if present
+    size_t carCount() const;
+
+    // Building blocks for merging results across several monitors.
+    ScoreTotals scoreTotals() const;
+    std::vector<std::pair<std::string, CarStatus>> statuses() const; // sorted by id
+
+    // Replaces the rule used for scores and the "all required present" check.
+    void setScoringModel(ScoringModel model);
+    // Streaming anomaly detection on every reading; on by default.
+    void setAnomalyLimits(ChannelId channel, const AnomalyLimits& limits);
+    void setAnomalyDetection(bool enabled);
 
 private:
     CarStatus statusOfUnlocked(const Car& car) const;
     mutable std::mutex mtx_;
     std::map<std::string, Car> cars_;
+    ScoringModel model_ = ScoringModel::standard();
+    AnomalyEngine anomaly_;
+    bool anomalyEnabled_ = true;
 };
 
 #endif // GARAGE_MONITOR_H
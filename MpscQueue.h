@@ -0,0 +1,74 @@
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include "CacheLine.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+
+// Bounded ring for any number of producer threads and exactly one consumer.
+// Each cell carries a sequence number (Vyukov's bounded queue): producers
+// claim a ticket with one CAS on tail_, fill the cell and publish it by
+// bumping its sequence; the consumer owns head_ outright. Pushes from one
+// thread are popped in the order they were made.
+template <typename T>
+class MpscQueue {
+public:
+    explicit MpscQueue(std::size_t capacity) {
+        std::size_t n = 2;
+        while (n < capacity) n <<= 1;
+        cells_ = std::make_unique<Cell[]>(n);
+        for (std::size_t i = 0; i < n; ++i) cells_[i].seq.store(i, std::memory_order_relaxed);
+        mask_ = n - 1;
+    }
+
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Any thread. Returns false (and leaves v untouched) when full.
+    bool tryPush(T& v) {
+        std::size_t pos = tail_.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells_[pos & mask_];
+            std::size_t seq = cell->seq.load(std::memory_order_acquire);
+            auto diff = static_cast<std::intptr_t>(seq) - static_cast<std::intptr_t>(pos);
+            if (diff == 0) {
+                if (tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                return false; // the consumer has not freed this cell yet
+            } else {
+                pos = tail_.load(std::memory_order_relaxed);
+            }
+        }
+        cell->value = std::move(v);
+        cell->seq.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Returns false when empty, or when the next ticket's
+    // producer has not finished writing it yet.
+    bool tryPop(T& out) {
+        Cell& cell = cells_[head_ & mask_];
+        if (cell.seq.load(std::memory_order_acquire) != head_ + 1) return false;
+        out = std::move(cell.value);
+        cell.seq.store(head_ + mask_ + 1, std::memory_order_release);
+        ++head_;
+        return true;
+    }
+
+private:
+    struct Cell {
+        std::atomic<std::size_t> seq{0};
+        T value;
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    std::size_t mask_ = 0;
+    alignas(CacheLineSize) std::size_t head_ = 0;               // consumer-local
+    alignas(CacheLineSize) std::atomic<std::size_t> tail_{0};   // shared by producers
+};
+
+#endif // MPSC_QUEUE_H
@@ -0,0 +1,282 @@
+#include "PartitionedMonitor.h"
+#include "MpscQueue.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <iomanip>
+#include <iterator>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#elif defined(_WIN32)
+#define NOMINMAX
+#include <windows.h>
+#endif
+
+namespace {
+
+constexpr size_t QueueCapacity = 4096;
+
+// CPUs this process may run on, in ascending order.
+std::vector<unsigned> allowedCpus() {
+    std::vector<unsigned> cpus;
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    if (sched_getaffinity(0, sizeof(set), &set) == 0) {
+        for (unsigned c = 0; c < CPU_SETSIZE; ++c) {
+            if (CPU_ISSET(c, &set)) cpus.push_back(c);
+        }
+    }
+#endif
+    if (cpus.empty()) {
+        unsigned n = std::max(1u, std::thread::hardware_concurrency());
+        for (unsigned c = 0; c < n; ++c) cpus.push_back(c);
+    }
+    return cpus;
+}
+
+void pinCurrentThread(unsigned cpu) {
+#if defined(__linux__)
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (pthread_setaffinity_np(pthread_self(), sizeof(set), &set) != 0) {
+        DEBUG_LOG("Could not pin worker to CPU " << cpu);
+    }
+#elif defined(_WIN32)
+    if (cpu < sizeof(DWORD_PTR) * 8) SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR{1} << cpu);
+#else
+    (void)cpu;
+#endif
+}
+
+} // namespace
+
+struct PartitionedMonitor::Message {
+    std::string carId;
+    ChannelId channel = InvalidChannel;
+    double value = 0.0;
+    std::function<void(GarageMonitor&)> task; // set for everything but plain updates
+    bool stop = false;
+};
+
+// Allocated by its own thread so the shard lands in that thread's local memory.
+struct alignas(CacheLineSize) PartitionedMonitor::Worker {
+    Worker() : queue(QueueCapacity) {}
+
+    MpscQueue<Message> queue;
+    GarageMonitor monitor;
+    std::atomic<size_t> dropped{0}; // messages whose handler threw; taken by flush()
+
+    void run() {
+        Message m;
+        unsigned idle = 0;
+        for (;;) {
+            if (!queue.tryPop(m)) {
+                ++idle;
+                if (idle > 256) std::this_thread::sleep_for(std::chrono::microseconds(50));
+                else if (idle > 64) std::this_thread::yield();
+                continue;
+            }
+            idle = 0;
+            if (m.stop) return;
+            // Task wrappers hand their exceptions to the caller. Anything else
+            // that throws (e.g. bad_alloc on ingest) is counted, not fatal.
+            try {
+                if (m.task) {
+                    m.task(monitor);
+                } else {
+                    monitor.addDiagnostic(m.carId, m.channel, m.value);
+                }
+            } catch (const std::exception& ex) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                DEBUG_LOG("Worker dropped message: " << ex.what());
+            } catch (...) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                DEBUG_LOG("Worker dropped message");
+            }
+            m.task = nullptr;
+        }
+    }
+};
+
+PartitionedMonitor::PartitionedMonitor(unsigned workers, bool pinThreads) {
+    std::vector<unsigned> cpus = allowedCpus();
+    if (workers == 0) workers = static_cast<unsigned>(cpus.size());
+
+    std::vector<std::promise<Worker*>> ready(workers);
+    threads_.reserve(workers);
+    for (unsigned i = 0; i < workers; ++i) {
+        unsigned cpu = cpus[i % cpus.size()];
+        threads_.emplace_back([pinThreads, cpu, &ready, i]{
+            if (pinThreads) pinCurrentThread(cpu);
+            auto self = std::make_unique<Worker>();
+            ready[i].set_value(self.get());
+            self->run();
+        });
+    }
+    workers_.reserve(workers);
+    for (auto& r : ready) workers_.push_back(r.get_future().get());
+}
+
+PartitionedMonitor::~PartitionedMonitor() {
+    for (unsigned i = 0; i < workerCount(); ++i) {
+        Message m;
+        m.stop = true;
+        push(i, m); // no other calls can be in flight during destruction
+    }
+    for (auto& th : threads_) th.join();
+}
+
+unsigned PartitionedMonitor::ownerOf(const std::string& carId) const {
+    return static_cast<unsigned>(std::hash<std::string>{}(carId) % workers_.size());
+}
+
+void PartitionedMonitor::push(unsigned worker, Message& m) const {
+    while (!workers_[worker]->queue.tryPush(m)) std::this_thread::yield();
+}
+
+void PartitionedMonitor::runOn(unsigned worker, const std::function<void(GarageMonitor&)>& task) const {
+    std::promise<void> done;
+    auto finished = done.get_future();
+    Message m;
+    m.task = [&task, &done](GarageMonitor& gm){
+        try {
+            task(gm);
+            done.set_value();
+        } catch (...) {
+            done.set_exception(std::current_exception());
+        }
+    };
+    push(worker, m);
+    finished.get();
+}
+
+void PartitionedMonitor::forEachWorker(const std::function<void(unsigned, GarageMonitor&)>& task) const {
+    std::vector<std::promise<void>> done(workers_.size());
+    std::vector<std::future<void>> finished;
+    finished.reserve(done.size());
+    for (auto& d : done) finished.push_back(d.get_future());
+    for (unsigned i = 0; i < workerCount(); ++i) {
+        Message m;
+        m.task = [&task, &done, i](GarageMonitor& gm){
+            try {
+                task(i, gm);
+                done[i].set_value();
+            } catch (...) {
+                done[i].set_exception(std::current_exception());
+            }
+        };
+        push(i, m);
+    }
+    // Every task refers to locals here, so wait for all before rethrowing.
+    for (auto& f : finished) f.wait();
+    for (auto& f : finished) f.get();
+}
+
+void PartitionedMonitor::addDiagnostic(const std::string& carId, DiagnosticType type, double value) {
+    addDiagnostic(carId, channelOf(type), value);
+}
+
+void PartitionedMonitor::addDiagnostic(const std::string& carId, ChannelId channel, double value) {
+    Message m;
+    m.carId = carId;
+    m.channel = channel;
+    m.value = value;
+    push(ownerOf(carId), m);
+}
+
+void PartitionedMonitor::addCar(const std::string& id) {
+    // Queued like an update and not waited for; a failure counts as dropped.
+    Message m;
+    m.task = [id](GarageMonitor& gm){ gm.addCar(id); };
+    push(ownerOf(id), m);
+}
+
+size_t PartitionedMonitor::loadCSV(std::istream& in, std::vector<std::string>& errors) {
+    return parseDiagnosticsCSV(in, errors, [this](const std::string& carId, ChannelId channel, double value){
+        addDiagnostic(carId, channel, value);
+    });
+}
+
+CarStatus PartitionedMonitor::statusOf(const std::string& carId) const {
+    CarStatus st;
+    runOn(ownerOf(carId), [&](GarageMonitor& gm){ st = gm.statusOf(carId); });
+    return st;
+}
+
+std::vector<std::pair<std::string, CarStatus>> PartitionedMonitor::statuses() const {
+    std::vector<std::vector<std::pair<std::string, CarStatus>>> parts(workerCount());
+    forEachWorker([&](unsigned i, GarageMonitor& gm){ parts[i] = gm.statuses(); });
+
+    std::vector<std::pair<std::string, CarStatus>> all;
+    for (auto& p : parts) std::move(p.begin(), p.end(), std::back_inserter(all));
+    std::sort(all.begin(), all.end(), [](const auto& a, const auto& b){ return a.first < b.first; });
+    return all;
+}
+
+void PartitionedMonitor::printStatus(std::ostream& out) const {
+    out << std::fixed << std::setprecision(2);
+    for (const auto& [id, st] : statuses()) printStatusLine(out, id, st);
+}
+
+std::optional<double> PartitionedMonitor::averageScore() const {
+    std::vector<ScoreTotals> parts(workerCount());
+    forEachWorker([&](unsigned i, GarageMonitor& gm){ parts[i] = gm.scoreTotals(); });
+    ScoreTotals total;
+    for (const auto& p : parts) { total.sum += p.sum; total.count += p.count; }
+    if (total.count == 0) return std::nullopt;
+    return total.sum / total.count;
+}
+
+bool PartitionedMonitor::hasCar(const std::string& id) const {
+    bool found = false;
+    runOn(ownerOf(id), [&](GarageMonitor& gm){ found = gm.hasCar(id); });
+    return found;
+}
+
+long long PartitionedMonitor::simulateRealTimeUpdates(int durationIterations) {
+    using namespace std::chrono;
+
+    std::vector<size_t> counts(workerCount());
+    forEachWorker([&](unsigned i, GarageMonitor& gm){ counts[i] = gm.carCount(); });
+    if (std::all_of(counts.begin(), counts.end(), [](size_t n){ return n == 0; })) {
+        for (const char* id : {"Car1", "Car2", "Car3"}) {
+            unsigned owner = ownerOf(id);
+            addCar(id);
+            ++counts[owner];
+        }
+    }
+
+    auto start = steady_clock::now();
+    forEachWorker([&](unsigned i, GarageMonitor& gm){
+        // An empty shard would seed its own demo cars; skip it.
+        if (counts[i] > 0) gm.simulateRealTimeUpdates(durationIterations, 1, false);
+    });
+    auto end = steady_clock::now();
+    return duration_cast<milliseconds>(end - start).count();
+}
+
+void PartitionedMonitor::setScoringModel(const ScoringModel& model) {
+    forEachWorker([&](unsigned, GarageMonitor& gm){ gm.setScoringModel(model); });
+}
+
+void PartitionedMonitor::setAnomalyLimits(ChannelId channel, const AnomalyLimits& limits) {
+    forEachWorker([&](unsigned, GarageMonitor& gm){ gm.setAnomalyLimits(channel, limits); });
+}
+
+void PartitionedMonitor::setAnomalyDetection(bool enabled) {
+    forEachWorker([&](unsigned, GarageMonitor& gm){ gm.setAnomalyDetection(enabled); });
+}
+
+size_t PartitionedMonitor::flush() const {
+    forEachWorker([](unsigned, GarageMonitor&){});
+    // Every drop counted before the barrier task is visible once it completes.
+    size_t dropped = 0;
+    for (Worker* w : workers_) dropped += w->dropped.exchange(0, std::memory_order_relaxed);
+    return dropped;
+}
@@ -0,0 +1,68 @@
+#ifndef PARTITIONED_MONITOR_H
+#define PARTITIONED_MONITOR_H
+
+#include "GarageMonitor.h"
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Ownership-partitioned alternative to a single shared GarageMonitor.
+// Each car belongs to one worker thread (chosen by hashing its id). Workers
+// are pinned to cores and allocate their shard themselves, so with first-touch
+// placement a car's memory stays on the owning core's NUMA node. Updates reach
+// the owner through that worker's MPSC queue; fleet-wide queries run on every
+// worker and the partial results are merged here.
+//
+// Any number of threads may call in concurrently. Queries travel through the
+// same queues, so a query sees every update that happened before it was
+// submitted (in particular, every earlier update from the same thread).
+class PartitionedMonitor {
+public:
+    // workers == 0 uses one worker per available core.
+    explicit PartitionedMonitor(unsigned workers = 0, bool pinThreads = true);
+    ~PartitionedMonitor();
+
+    PartitionedMonitor(const PartitionedMonitor&) = delete;
+    PartitionedMonitor& operator=(const PartitionedMonitor&) = delete;
+
+    void addDiagnostic(const std::string& carId, DiagnosticType type, double value);
+    void addDiagnostic(const std::string& carId, ChannelId channel, double value);
+    void addCar(const std::string& id); // no-op if present
+    size_t loadCSV(std::istream& in, std::vector<std::string>& errors); // throws on empty CSV
+
+    CarStatus statusOf(const std::string& carId) const;
+    void printStatus(std::ostream& out) const;
+    std::vector<std::pair<std::string, CarStatus>> statuses() const; // sorted by id
+    std::optional<double> averageScore() const;
+    bool hasCar(const std::string& id) const;
+    // Each worker updates only the cars it owns; returns elapsed ms.
+    long long simulateRealTimeUpdates(int durationIterations);
+
+    void setScoringModel(const ScoringModel& model);
+    void setAnomalyLimits(ChannelId channel, const AnomalyLimits& limits);
+    void setAnomalyDetection(bool enabled);
+
+    // Returns once every queued update is applied, with the number of updates
+    // dropped since the previous flush because applying them threw.
+    size_t flush() const;
+
+    // Runs task on every worker's shard and waits for all of them. The first
+    // exception thrown by a task is rethrown here once every worker is done.
+    void forEachWorker(const std::function<void(unsigned, GarageMonitor&)>& task) const;
+
+    unsigned workerCount() const { return static_cast<unsigned>(workers_.size()); }
+    unsigned ownerOf(const std::string& carId) const;
+
+private:
+    struct Message;
+    struct Worker;
+
+    void push(unsigned worker, Message& m) const;
+    void runOn(unsigned worker, const std::function<void(GarageMonitor&)>& task) const;
+
+    std::vector<Worker*> workers_; // owned by their threads
+    std::vector<std::thread> threads_;
+};
+
+#endif // PARTITIONED_MONITOR_H
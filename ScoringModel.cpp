@@ -0,0 +1,53 @@
+#include "ScoringModel.h"
+#include "Car.h"
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+ScoringModel::ScoringModel(double baseline) : baseline_(baseline) {}
+
+const ScoringModel& ScoringModel::standard() {
+    static const ScoringModel model = [] {
+        ScoringModel m;
+        m.addTerm(ChannelRPM, 1.0 / 100.0)
+         .addTerm(ChannelEngineLoad, 0.5)
+         .addTerm(ChannelCoolantTemp, 2.0, 90.0);
+        return m;
+    }();
+    return model;
+}
+
+static void checkRegistered(ChannelId channel) {
+    // A misspelt name looked up with find() yields InvalidChannel; without this
+    // check it would size the required set and fail every car.
+    if (channel >= ChannelRegistry::instance().size()) {
+        throw std::invalid_argument("Scoring rule refers to unregistered channel id " + std::to_string(channel));
+    }
+}
+
+ScoringModel& ScoringModel::addTerm(ChannelId channel, double weight, double offset) {
+    checkRegistered(channel);
+    terms_.push_back(Term{channel, weight, offset});
+    return require(channel);
+}
+
+ScoringModel& ScoringModel::require(ChannelId channel) {
+    checkRegistered(channel);
+    if (std::find(required_.begin(), required_.end(), channel) == required_.end()) {
+        required_.push_back(channel);
+    }
+    return *this;
+}
+
+bool ScoringModel::hasAllRequired(const Car& car) const {
+    return std::all_of(required_.begin(), required_.end(), [&](ChannelId ch){ return car.has(ch); });
+}
+
+std::optional<double> ScoringModel::score(const Car& car) const {
+    if (!hasAllRequired(car)) return std::nullopt;
+    double penalty = 0.0;
+    for (const Term& t : terms_) {
+        penalty += (car.valueUnchecked(t.channel) - t.offset) * t.weight;
+    }
+    return baseline_ - penalty;
+}
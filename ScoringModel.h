@@ -0,0 +1,43 @@
+#ifndef SCORING_MODEL_H
+#define SCORING_MODEL_H
+
+#include "Channel.h"
+#include <optional>
+#include <vector>
+
+class Car;
+
+// Linear penalty over any registered channels:
+//   score = baseline - sum(weight * (value - offset))
+// Every channel a term refers to is required; further channels can be
+// required without contributing to the score.
+class ScoringModel {
+public:
+    struct Term {
+        ChannelId channel;
+        double weight;
+        double offset;
+    };
+
+    explicit ScoringModel(double baseline = 100.0);
+
+    // 100 - (rpm/100 + engineLoad*0.5 + (coolantTemp - 90) * 2)
+    static const ScoringModel& standard();
+
+    // Both throw std::invalid_argument for ids the registry never handed out.
+    ScoringModel& addTerm(ChannelId channel, double weight, double offset = 0.0);
+    ScoringModel& require(ChannelId channel);
+
+    const std::vector<ChannelId>& required() const { return required_; }
+    const std::vector<Term>& terms() const { return terms_; }
+
+    bool hasAllRequired(const Car& car) const;
+    std::optional<double> score(const Car& car) const;
+
+private:
+    double baseline_;
+    std::vector<Term> terms_;
+    std::vector<ChannelId> required_; // no duplicates
+};
+
+#endif // SCORING_MODEL_H
@@ -0,0 +1,93 @@
+#include "GarageMonitor.h"
+#include "PartitionedMonitor.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Shared-lock GarageMonitor vs ownership-partitioned PartitionedMonitor on the
+// same ingest load from the same number of producer threads, plus one
+// fleet-wide query each.
+// Usage: bench_partition [cars] [readings] [threads]   (build with -DCMAKE_BUILD_TYPE=Release)
+
+struct Rng { // xorshift64*
+    std::uint64_t s;
+    std::uint64_t next() { s ^= s >> 12; s ^= s << 25; s ^= s >> 27; return s * 2685821657736338717ull; }
+    double unit() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+};
+
+template <typename Monitor>
+static void ingestRange(Monitor& gm, const std::vector<std::string>& ids, long long readings, std::uint64_t seed) {
+    Rng rng{seed};
+    for (long long i = 0; i < readings; ++i) {
+        const std::string& id = ids[rng.next() % ids.size()];
+        switch (i % 3) {
+            case 0: gm.addDiagnostic(id, ChannelRPM, 600.0 + rng.unit() * 6400.0); break;
+            case 1: gm.addDiagnostic(id, ChannelEngineLoad, rng.unit() * 100.0); break;
+            default: gm.addDiagnostic(id, ChannelCoolantTemp, 70.0 + rng.unit() * 60.0); break;
+        }
+    }
+}
+
+// Splits readings over threads producers, each with its own seed.
+template <typename Monitor>
+static void ingestParallel(Monitor& gm, const std::vector<std::string>& ids, long long readings, unsigned threads) {
+    std::vector<std::thread> pool;
+    for (unsigned t = 0; t < threads; ++t) {
+        pool.emplace_back([&, t]{ ingestRange(gm, ids, readings / threads, 1000 + t); });
+    }
+    for (auto& th : pool) th.join();
+}
+
+template <typename F>
+static double millis(F f) {
+    auto start = std::chrono::steady_clock::now();
+    f();
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(end - start).count();
+}
+
+int main(int argc, char* argv[]) {
+    long long cars = (argc >= 2) ? std::stoll(argv[1]) : 200000;
+    long long readings = (argc >= 3) ? std::stoll(argv[2]) : 6000000;
+    unsigned threads = (argc >= 4) ? static_cast<unsigned>(std::stoul(argv[3]))
+                                   : std::max(1u, std::thread::hardware_concurrency());
+
+    std::vector<std::string> ids;
+    ids.reserve(cars);
+    for (long long i = 0; i < cars; ++i) ids.push_back("Car" + std::to_string(i));
+
+    std::cout << std::fixed << std::setprecision(1)
+              << "Fleet: " << cars << " cars, " << readings << " readings, " << threads << " thread(s)\n";
+
+    double sharedIngest, sharedQuery;
+    {
+        GarageMonitor gm;
+        for (const auto& id : ids) gm.addCar(id);
+        sharedIngest = millis([&]{ ingestParallel(gm, ids, readings, threads); });
+        sharedQuery = millis([&]{ (void)gm.averageScore(); });
+    }
+
+    double partIngest, partQuery;
+    {
+        PartitionedMonitor pm(threads);
+        for (const auto& id : ids) pm.addCar(id);
+        pm.flush();
+        partIngest = millis([&]{
+            ingestParallel(pm, ids, readings, threads);
+            pm.flush();
+        });
+        partQuery = millis([&]{ (void)pm.averageScore(); });
+    }
+
+    long long done = (readings / threads) * threads;
+    std::cout << "Shared lock:  ingest " << sharedIngest << " ms (" << done / sharedIngest / 1000.0
+              << " M readings/s) | averageScore " << sharedQuery << " ms\n"
+              << "Partitioned:  ingest " << partIngest << " ms (" << done / partIngest / 1000.0
+              << " M readings/s) | averageScore " << partQuery << " ms\n";
+    return 0;
+}
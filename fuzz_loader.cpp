@@ -0,0 +1,326 @@
+#include "GarageMonitor.h"
+#include "PartitionedMonitor.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+// Differential fuzz target: every CSV loader must produce exactly what the
+// reference GarageMonitor::loadCSV produces (row count or exception, error
+// list, and the status of every car). The reference itself is checked row by
+// row against a frozen copy of the loader from before channels became
+// registrable. A mismatch aborts with both sides printed.
+//
+// libFuzzer (clang):  cmake -DGARAGE_LIBFUZZER=ON ..  then  ./fuzz_loader corpus/
+// Standalone driver:  ./fuzz_loader file...            replays the given inputs
+//                     ./fuzz_loader --random N [seed]  generates N CSV inputs
+
+namespace {
+
+struct LoadResult {
+    bool threw = false;
+    std::string what;
+    size_t count = 0;
+    std::vector<std::string> errors;
+    std::vector<std::pair<std::string, CarStatus>> statuses;
+};
+
+template <typename Monitor>
+LoadResult load(Monitor& m, const std::string& text) {
+    LoadResult r;
+    std::istringstream in(text);
+    try {
+        r.count = m.loadCSV(in, r.errors);
+    } catch (const std::exception& ex) {
+        r.threw = true;
+        r.what = ex.what();
+    }
+    r.statuses = m.statuses();
+    return r;
+}
+
+void dump(std::ostream& out, const char* label, const LoadResult& r) {
+    out << label << ": " << (r.threw ? "threw '" + r.what + "'" : std::to_string(r.count) + " row(s)")
+        << ", " << r.errors.size() << " error(s)\n";
+    for (const auto& e : r.errors) out << "  " << e << "\n";
+    for (const auto& [id, st] : r.statuses) printStatusLine(out << "  ", id, st);
+}
+
+bool same(const LoadResult& a, const LoadResult& b) {
+    if (a.threw != b.threw || a.what != b.what || a.count != b.count || a.errors != b.errors) return false;
+    if (a.statuses.size() != b.statuses.size()) return false;
+    for (size_t i = 0; i < a.statuses.size(); ++i) {
+        if (a.statuses[i].first != b.statuses[i].first) return false;
+        if (!sameStatus(a.statuses[i].second, b.statuses[i].second)) return false;
+    }
+    return true;
+}
+
+void expectSame(const LoadResult& ref, const LoadResult& alt, const char* altName, const std::string& input) {
+    if (same(ref, alt)) return;
+    std::cerr << "Loader mismatch: " << altName << " differs from GarageMonitor::loadCSV\n"
+              << "--- input (" << input.size() << " bytes) ---\n" << input << "\n--- end input ---\n";
+    dump(std::cerr, "GarageMonitor", ref);
+    dump(std::cerr, altName, alt);
+    std::abort();
+}
+
+// The loader as it was when only the three built-in types existed, kept
+// verbatim apart from collecting rows instead of storing them. Do not update
+// it to follow GarageMonitor; it is the oracle. It holds while only the
+// built-in channels are registered, which this binary never changes.
+namespace baseline {
+
+struct Row {
+    std::string carId;
+    DiagnosticType type;
+    double value;
+};
+
+std::string trim(const std::string& s) {
+    size_t start = 0, end = s.size();
+    while (start < end && std::isspace(static_cast<unsigned char>(s[start]))) ++start;
+    while (end > start && std::isspace(static_cast<unsigned char>(s[end-1]))) --end;
+    return s.substr(start, end - start);
+}
+
+std::string upper(std::string s) {
+    std::transform(s.begin(), s.end(), s.begin(), [](unsigned char c){ return std::toupper(c); });
+    return s;
+}
+
+DiagnosticType typeFromString(const std::string& sIn) {
+    std::string s = upper(trim(sIn));
+    if (s == "RPM") return DiagnosticType::RPM;
+    if (s == "ENGINELOAD") return DiagnosticType::EngineLoad;
+    if (s == "COOLANTTEMP") return DiagnosticType::CoolantTemp;
+    return DiagnosticType::Unknown;
+}
+
+size_t loadCSV(std::istream& in, std::vector<std::string>& errors, std::vector<Row>& rows) {
+    size_t count = 0;
+    std::string line;
+    size_t lineNo = 0;
+    while (std::getline(in, line)) {
+        ++lineNo;
+        std::string raw = trim(line);
+        if (raw.empty()) continue;
+        if (!raw.empty() && raw[0] == '#') continue;
+
+        std::stringstream ss(raw);
+        std::string carId, typeStr, valueStr;
+
+        if (!std::getline(ss, carId, ',')) {
+            errors.push_back("Line " + std::to_string(lineNo) + ": missing CarId");
+            continue;
+        }
+        if (!std::getline(ss, typeStr, ',')) {
+            errors.push_back("Line " + std::to_string(lineNo) + ": missing Type");
+            continue;
+        }
+        if (!std::getline(ss, valueStr, ',')) {
+            valueStr = "";
+        }
+
+        carId    = trim(carId);
+        typeStr  = trim(typeStr);
+        valueStr = trim(valueStr);
+
+        DiagnosticType type = typeFromString(typeStr);
+        if (type == DiagnosticType::Unknown) {
+            errors.push_back("Line " + std::to_string(lineNo) + ": unknown Type '" + typeStr + "'");
+            continue;
+        }
+
+        char* endp = nullptr;
+        errno = 0;
+        double val = std::strtod(valueStr.c_str(), &endp);
+        if (valueStr.empty() || endp == valueStr.c_str() || errno == ERANGE) {
+            errors.push_back("Line " + std::to_string(lineNo) + ": invalid Value '" + valueStr + "'");
+            continue;
+        }
+
+        rows.push_back(Row{carId, type, val});
+        ++count;
+    }
+    if (count == 0) {
+        throw std::runtime_error("Empty CSV: no valid data rows.");
+    }
+    return count;
+}
+
+} // namespace baseline
+
+// Rows as each parser hands them on, plus what it reported.
+struct ParseResult {
+    bool threw = false;
+    std::string what;
+    size_t count = 0;
+    std::vector<std::string> errors;
+    std::vector<std::string> carIds;
+    std::vector<ChannelId> channels;
+    std::vector<double> values;
+};
+
+ParseResult parseBaseline(const std::string& text) {
+    ParseResult r;
+    std::istringstream in(text);
+    std::vector<baseline::Row> rows;
+    try {
+        r.count = baseline::loadCSV(in, r.errors, rows);
+    } catch (const std::exception& ex) {
+        r.threw = true;
+        r.what = ex.what();
+    }
+    for (const auto& row : rows) {
+        r.carIds.push_back(row.carId);
+        r.channels.push_back(channelOf(row.type));
+        r.values.push_back(row.value);
+    }
+    return r;
+}
+
+ParseResult parseCurrent(const std::string& text) {
+    ParseResult r;
+    std::istringstream in(text);
+    try {
+        r.count = parseDiagnosticsCSV(in, r.errors, [&](const std::string& carId, ChannelId ch, double v){
+            r.carIds.push_back(carId);
+            r.channels.push_back(ch);
+            r.values.push_back(v);
+        });
+    } catch (const std::exception& ex) {
+        r.threw = true;
+        r.what = ex.what();
+    }
+    return r;
+}
+
+bool sameRows(const ParseResult& a, const ParseResult& b) {
+    if (a.threw != b.threw || a.what != b.what || a.count != b.count || a.errors != b.errors) return false;
+    if (a.carIds != b.carIds || a.channels != b.channels || a.values.size() != b.values.size()) return false;
+    for (size_t i = 0; i < a.values.size(); ++i) {
+        bool bothNaN = std::isnan(a.values[i]) && std::isnan(b.values[i]);
+        if (!bothNaN && a.values[i] != b.values[i]) return false;
+    }
+    return true;
+}
+
+void dumpRows(std::ostream& out, const char* label, const ParseResult& r) {
+    out << label << ": " << (r.threw ? "threw '" + r.what + "'" : std::to_string(r.count) + " row(s)")
+        << ", " << r.errors.size() << " error(s)\n";
+    for (const auto& e : r.errors) out << "  " << e << "\n";
+    for (size_t i = 0; i < r.carIds.size(); ++i) {
+        out << "  '" << r.carIds[i] << "' channel " << r.channels[i] << " = " << r.values[i] << "\n";
+    }
+}
+
+void expectBaseline(const std::string& input) {
+    ParseResult base = parseBaseline(input);
+    ParseResult cur = parseCurrent(input);
+    if (sameRows(base, cur)) return;
+    std::cerr << "Loader mismatch: parseDiagnosticsCSV differs from the baseline loader\n"
+              << "--- input (" << input.size() << " bytes) ---\n" << input << "\n--- end input ---\n";
+    dumpRows(std::cerr, "baseline", base);
+    dumpRows(std::cerr, "parseDiagnosticsCSV", cur);
+    std::abort();
+}
+
+void runOne(const std::string& input) {
+    expectBaseline(input);
+
+    GarageMonitor reference;
+    LoadResult ref = load(reference, input);
+    {
+        PartitionedMonitor pm(1, false);
+        expectSame(ref, load(pm, input), "PartitionedMonitor(1 worker)", input);
+    }
+    {
+        PartitionedMonitor pm(3, false);
+        expectSame(ref, load(pm, input), "PartitionedMonitor(3 workers)", input);
+    }
+}
+
+// Mostly well-formed rows with the edge cases the parser has to handle.
+std::string randomCSV(std::mt19937_64& rng) {
+    static const char* ids[] = {"Car1", "Car2", " car1", "CAR1", "", "Car,3", "Ünï"};
+    static const char* types[] = {"RPM", "rpm", " EngineLoad ", "COOLANTTEMP", "coolanttemp",
+                                  "Bogus", "", "RPMX", "Engine Load"};
+    static const char* values[] = {"0", "6500", "-1", "1e3", "  42  ", "abc", "", "1e999",
+                                   "nan", "inf", "0x1A", "12abc", "-0", "4.9e-324"};
+    static const char* spaces[] = {"", " ", "\t", "  ", "\r"};
+    auto pick = [&](auto& arr) { return arr[rng() % std::size(arr)]; };
+
+    std::string out;
+    int lines = static_cast<int>(rng() % 40);
+    for (int i = 0; i < lines; ++i) {
+        switch (rng() % 16) {
+            case 0: out += "# comment\n"; continue;
+            case 1: out += pick(spaces); out += "\n"; continue;
+            case 2: { // raw bytes
+                int n = static_cast<int>(rng() % 12);
+                for (int k = 0; k < n; ++k) out += static_cast<char>(rng() % 256);
+                out += "\n";
+                continue;
+            }
+            default: break;
+        }
+        out += pick(spaces); out += pick(ids); out += pick(spaces);
+        if (rng() % 20 == 0) { out += "\n"; continue; } // missing Type
+        out += ","; out += pick(spaces); out += pick(types); out += pick(spaces);
+        if (rng() % 20 == 0) { out += "\n"; continue; } // missing Value
+        out += ",";
+        if (rng() % 3 == 0) out += std::to_string(std::uniform_real_distribution<double>(-50, 8000)(rng));
+        else out += pick(values);
+        out += pick(spaces);
+        if (rng() % 15 == 0) out += ",extra";
+        if (rng() % 25 != 0) out += "\n"; // sometimes no trailing newline
+    }
+    return out;
+}
+
+} // namespace
+
+extern "C" int LLVMFuzzerTestOneInput(const std::uint8_t* data, std::size_t size) {
+    runOne(std::string(reinterpret_cast<const char*>(data), size));
+    return 0;
+}
+
+#ifndef GARAGE_LIBFUZZER
+int main(int argc, char* argv[]) {
+    if (argc >= 2 && std::string(argv[1]) == "--random") {
+        long long n = (argc >= 3) ? std::stoll(argv[2]) : 1000;
+        std::uint64_t seed = (argc >= 4) ? std::stoull(argv[3]) : 1;
+        std::mt19937_64 rng(seed);
+        for (long long i = 0; i < n; ++i) runOne(randomCSV(rng));
+        std::cout << "fuzz_loader: " << n << " random input(s) matched (seed " << seed << ")\n";
+        return 0;
+    }
+    if (argc < 2) {
+        std::cerr << "Usage:\n"
+                  << "  " << argv[0] << " <input>...\n"
+                  << "  " << argv[0] << " --random [count] [seed]\n";
+        return 1;
+    }
+    for (int i = 1; i < argc; ++i) {
+        std::ifstream in(argv[i], std::ios::binary);
+        if (!in) {
+            std::cerr << "Error: cannot open file: " << argv[i] << "\n";
+            return 1;
+        }
+        runOne(std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()));
+    }
+    std::cout << "fuzz_loader: " << (argc - 1) << " input(s) matched\n";
+    return 0;
+}
+#endif
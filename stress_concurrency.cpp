@@ -0,0 +1,202 @@
+#include "GarageMonitor.h"
+#include "PartitionedMonitor.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Replays randomized multi-thread schedules against one GarageMonitor, then
+// the same kind of schedule against one PartitionedMonitor, every round.
+// Built with -fsanitize=thread as the stress_tsan target, so any data race
+// fails the run. Each thread also writes a few cars nobody else touches;
+// in verified rounds those cars must end up exactly as a sequential
+// GarageMonitor replay of that thread's writes leaves them.
+//
+// Usage: stress_tsan [rounds=24] [threads=4] [seed=1]
+
+namespace {
+
+struct Write {
+    std::string carId;
+    ChannelId channel;
+    double value;
+};
+
+struct Schedule {
+    std::vector<Write> ownWrites; // replayed sequentially for verification
+};
+
+double randomValue(std::mt19937_64& rng, ChannelId ch) {
+    switch (ch) {
+        case ChannelRPM: return std::uniform_real_distribution<double>(600, 7000)(rng);
+        case ChannelEngineLoad: return std::uniform_real_distribution<double>(0, 100)(rng);
+        default: return std::uniform_real_distribution<double>(70, 130)(rng);
+    }
+}
+
+void jitter(std::mt19937_64& rng) {
+    switch (rng() % 8) {
+        case 0: std::this_thread::yield(); break;
+        case 1: std::this_thread::sleep_for(std::chrono::microseconds(rng() % 50)); break;
+        default: break;
+    }
+}
+
+// Calls whose signatures differ between the two monitors.
+void simulate(GarageMonitor& gm) { gm.simulateRealTimeUpdates(1, 2, true); }
+void simulate(PartitionedMonitor& pm) { pm.simulateRealTimeUpdates(1); }
+
+void fanOut(GarageMonitor& gm, std::mt19937_64&) { (void)gm.carCount(); }
+void fanOut(PartitionedMonitor& pm, std::mt19937_64& rng) {
+    std::vector<size_t> counts(pm.workerCount());
+    pm.forEachWorker([&](unsigned i, GarageMonitor& shard){ counts[i] = shard.carCount(); });
+
+    unsigned bad = static_cast<unsigned>(rng() % pm.workerCount());
+    bool threw = false;
+    try {
+        pm.forEachWorker([bad](unsigned i, GarageMonitor&){ if (i == bad) throw std::runtime_error("stress"); });
+    } catch (const std::runtime_error&) {
+        threw = true;
+    }
+    if (!threw) {
+        std::cerr << "forEachWorker swallowed a task exception\n";
+        std::abort();
+    }
+
+    if (rng() % 4 == 0) { // construct/destroy churn next to the long-lived monitor
+        PartitionedMonitor shortLived(2, false);
+        shortLived.addDiagnostic("Churn", ChannelRPM, 1000.0);
+        shortLived.addCar("Churn2");
+        (void)shortLived.statusOf("Churn");
+    }
+}
+
+template <typename Monitor>
+void runThread(Monitor& gm, int round, int t, bool chaos, std::uint64_t seed,
+               const std::atomic<bool>& go, Schedule& sched) {
+    std::mt19937_64 rng(seed);
+    std::vector<ChannelId> channels = {ChannelRPM, ChannelEngineLoad, ChannelCoolantTemp};
+    auto ownCar = [&]{ return "T" + std::to_string(t) + "-" + std::to_string(rng() % 3); };
+    auto anyCar = [&]{ return "Shared" + std::to_string(rng() % 4); };
+
+    while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+
+    for (int op = 0; op < 200; ++op) {
+        jitter(rng);
+        switch (rng() % 15) {
+            case 0: case 1: case 2: case 3: { // own car
+                Write w{ownCar(), channels[rng() % channels.size()], 0.0};
+                w.value = randomValue(rng, w.channel);
+                gm.addDiagnostic(w.carId, w.channel, w.value);
+                sched.ownWrites.push_back(w);
+                break;
+            }
+            case 4: case 5: { // contended car
+                ChannelId ch = channels[rng() % channels.size()];
+                gm.addDiagnostic(anyCar(), ch, randomValue(rng, ch));
+                break;
+            }
+            case 6: { // own car through the CSV path
+                Write w{ownCar(), ChannelCoolantTemp, randomValue(rng, ChannelCoolantTemp)};
+                std::ostringstream csv;
+                csv.precision(17); // round-trips through strtod exactly
+                csv << w.carId << ", CoolantTemp, " << w.value << "\n" << w.carId << ", Bogus, 1\n";
+                std::istringstream in(csv.str());
+                std::vector<std::string> errors;
+                gm.loadCSV(in, errors);
+                sched.ownWrites.push_back(w);
+                break;
+            }
+            case 7: (void)gm.statusOf(rng() % 2 ? ownCar() : anyCar()); break;
+            case 8: (void)gm.averageScore(); break;
+            case 9: { std::ostringstream out; gm.printStatus(out); break; }
+            case 10: (void)gm.statuses(); (void)gm.hasCar(anyCar()); break;
+            case 11: { // grow the channel table while others read it
+                if (rng() % 4 != 0) break;
+                std::string name = "Stress" + std::to_string(round) + "_" + std::to_string(t) + "_" + std::to_string(op);
+                ChannelId ch = ChannelRegistry::instance().registerChannel(name);
+                channels.push_back(ch);
+                break;
+            }
+            case 12: // same settings, re-applied concurrently
+                gm.setScoringModel(ScoringModel::standard());
+                gm.setAnomalyLimits(ChannelRPM, AnomalyEngine().limits(ChannelRPM));
+                break;
+            case 13: fanOut(gm, rng); break;
+            default:
+                // Touches every car, own ones included, so only in unverified rounds.
+                if (chaos) simulate(gm);
+                break;
+        }
+    }
+}
+
+// Runs one round against m; in verified rounds, compares each thread's own
+// cars with a sequential replay. Returns false on a mismatch.
+template <typename Monitor>
+bool runRound(Monitor& m, const char* label, int round, int threadsN, bool chaos,
+              std::mt19937_64& master, std::uint64_t seed) {
+    std::vector<Schedule> scheds(threadsN);
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < threadsN; ++t) {
+        threads.emplace_back(runThread<Monitor>, std::ref(m), round, t, chaos, master(),
+                             std::cref(go), std::ref(scheds[t]));
+    }
+    go.store(true, std::memory_order_release);
+    for (auto& th : threads) th.join();
+
+    if (chaos) return true;
+    GarageMonitor reference;
+    for (const auto& s : scheds) {
+        for (const auto& w : s.ownWrites) reference.addDiagnostic(w.carId, w.channel, w.value);
+    }
+    for (const auto& [id, expected] : reference.statuses()) {
+        CarStatus got = m.statusOf(id);
+        if (!sameStatus(got, expected)) {
+            std::ostringstream want, have;
+            printStatusLine(want, id, expected);
+            printStatusLine(have, id, got);
+            std::cerr << label << " round " << round << " (seed " << seed << "): " << id << " diverged\n"
+                      << "  expected " << want.str() << "  got      " << have.str();
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int rounds = (argc >= 2) ? std::stoi(argv[1]) : 24;
+    int threadsN = (argc >= 3) ? std::stoi(argv[2]) : 4;
+    std::uint64_t seed = (argc >= 4) ? std::stoull(argv[3]) : 1;
+
+    std::mt19937_64 master(seed);
+    for (int round = 0; round < rounds; ++round) {
+        bool chaos = round % 2 == 1;
+        {
+            GarageMonitor gm;
+            if (!runRound(gm, "GarageMonitor", round, threadsN, chaos, master, seed)) return 1;
+        }
+        {
+            PartitionedMonitor pm(3, false);
+            if (!runRound(pm, "PartitionedMonitor", round, threadsN, chaos, master, seed)) return 1;
+            if (size_t dropped = pm.flush()) {
+                std::cerr << "PartitionedMonitor round " << round << " (seed " << seed << "): "
+                          << dropped << " update(s) dropped\n";
+                return 1;
+            }
+        }
+    }
+    std::cout << "stress_tsan: " << rounds << " round(s) x " << threadsN << " thread(s) passed (seed "
+              << seed << ")\n";
+    return 0;
+}
@@ -1,9 +1,15 @@
 #include "GarageMonitor.h"
+#include "PartitionedMonitor.h"
 #include <cassert>
 #include <sstream>
 #include <iostream>
 #include <cmath>
 #include <vector>
+#include <random>
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
 
 static bool approx(double a, double b, double eps = 1e-9) {
     return std::fabs(a - b) < eps;
@@ -150,6 +156,251 @@ int main() {
         assert(avg.has_value());
     }
 
+    // 11) Registered channels: case-insensitive lookup stays exact across ~40 names
+    {
+        auto& reg = ChannelRegistry::instance();
+        std::vector<ChannelId> ids;
+        for (int i = 0; i < 40; ++i) ids.push_back(reg.registerChannel("ObdPid" + std::to_string(i)));
+        for (int i = 0; i < 40; ++i) {
+            assert(reg.find(" obdpid" + std::to_string(i) + " ") == ids[i]);
+            assert(reg.name(ids[i]) == "ObdPid" + std::to_string(i));
+        }
+        assert(reg.registerChannel("OBDPID7") == ids[7]);
+        assert(reg.find("ObdPid40") == InvalidChannel);
+        assert(reg.find("rpm") == ChannelRPM);
+        assert(diagnosticTypeFromString(" coolanttemp ") == DiagnosticType::CoolantTemp);
+        assert(diagnosticTypeFromString("ObdPid3") == DiagnosticType::Unknown);
+    }
+
+    // 12) CSV rows for a registered channel load; scoring rules can use it
+    {
+        ChannelId oil = ChannelRegistry::instance().registerChannel("OilPressure");
+        GarageMonitor gm;
+        ScoringModel model = ScoringModel::standard();
+        model.addTerm(oil, 1.0, 40.0); // penalty per unit above 40
+        gm.setScoringModel(model);
+        std::stringstream csv(
+            "CarO, RPM, 0\n"
+            "CarO, EngineLoad, 0\n"
+            "CarO, CoolantTemp, 90\n"
+        );
+        std::vector<std::string> errors;
+        gm.loadCSV(csv, errors);
+        auto st = gm.statusOf("CarO");
+        assert(!st.hasAll); // OilPressure now required
+        std::stringstream more("CarO, oilpressure, 50\n");
+        assert(gm.loadCSV(more, errors) == 1);
+        st = gm.statusOf("CarO");
+        assert(st.hasAll);
+        assert(approx(*st.score, 90.0));
+
+        // A misspelt channel in a rule is rejected up front
+        bool threw = false;
+        try { model.addTerm(ChannelRegistry::instance().find("OilPresure"), 1.0); }
+        catch (const std::invalid_argument&) { threw = true; }
+        assert(threw);
+        threw = false;
+        try { model.require(1000000); }
+        catch (const std::invalid_argument&) { threw = true; }
+        assert(threw);
+    }
+
+    // 13) Channel registered after a car exists still gets a slot
+    {
+        GarageMonitor gm;
+        gm.addDiagnostic("Late", DiagnosticType::RPM, 1000);
+        ChannelId batt = ChannelRegistry::instance().registerChannel("BatteryVoltage");
+        gm.addDiagnostic("Late", batt, 12.6);
+        gm.addDiagnostic("Late", DiagnosticType::EngineLoad, 10);
+        gm.addDiagnostic("Late", DiagnosticType::CoolantTemp, 90);
+        auto st = gm.statusOf("Late");
+        assert(st.hasAll); // standard model ignores BatteryVoltage
+        assert(approx(*st.score, 85.0));
+
+        // Ids the registry never handed out are dropped, not given a slot
+        gm.addDiagnostic("Late", ChannelId{1000000}, 1.0);
+        gm.addDiagnostic("Late", static_cast<ChannelId>(ChannelRegistry::instance().size()), 1.0);
+        assert(sameStatus(gm.statusOf("Late"), st));
+        Car car("Direct");
+        car.set(1000000, 1.0);
+        assert(!car.value(1000000).has_value());
+    }
+
+    // 14) RPM stuck at one value is flagged; a varying signal is not
+    {
+        GarageMonitor gm;
+        gm.addDiagnostic("Stk", DiagnosticType::EngineLoad, 10);
+        gm.addDiagnostic("Stk", DiagnosticType::CoolantTemp, 90);
+        for (int i = 0; i < 10; ++i) gm.addDiagnostic("Stk", DiagnosticType::RPM, 1000 + i * 10);
+        assert(gm.statusOf("Stk").anomalies.empty());
+        for (int i = 0; i < 20; ++i) gm.addDiagnostic("Stk", DiagnosticType::RPM, 1500);
+        auto st = gm.statusOf("Stk");
+        assert(st.alert == "Sensor Stuck");
+        assert(st.anomalies.size() == 1 && st.anomalies[0] == "RPM: Sensor Stuck");
+        gm.addDiagnostic("Stk", DiagnosticType::RPM, 1510);
+        assert(gm.statusOf("Stk").anomalies.empty());
+
+        // Disabling detection drops flags raised before the switch
+        for (int i = 0; i < 20; ++i) gm.addDiagnostic("Stk", DiagnosticType::RPM, 1500);
+        assert(gm.statusOf("Stk").alert == "Sensor Stuck");
+        gm.setAnomalyDetection(false);
+        gm.addDiagnostic("Stk", DiagnosticType::RPM, 2500);
+        gm.addDiagnostic("Stk", DiagnosticType::RPM, 3000);
+        st = gm.statusOf("Stk");
+        assert(st.alert.empty() && st.anomalies.empty());
+        gm.setAnomalyDetection(true);
+        assert(gm.statusOf("Stk").anomalies.empty());
+
+        // Limits for unregistered ids are rejected, not written out of bounds
+        bool threw = false;
+        try { gm.setAnomalyLimits(ChannelRegistry::instance().find("typo"), AnomalyLimits{}); }
+        catch (const std::invalid_argument&) { threw = true; }
+        assert(threw);
+        threw = false;
+        try { gm.setAnomalyLimits(1000000, AnomalyLimits{}); }
+        catch (const std::invalid_argument&) { threw = true; }
+        assert(threw);
+    }
+
+    // 15) Coolant temperature drifting upward raises Sensor Drift before any spike
+    {
+        GarageMonitor gm;
+        std::mt19937 rng(7);
+        std::uniform_real_distribution<double> noise(-0.5, 0.5);
+        for (int i = 0; i < 200; ++i) gm.addDiagnostic("Drf", DiagnosticType::CoolantTemp, 90 + noise(rng));
+        assert(gm.statusOf("Drf").anomalies.empty());
+        bool drift = false;
+        double temp = 90;
+        for (int i = 0; i < 100 && !drift; ++i) {
+            temp += 0.1;
+            gm.addDiagnostic("Drf", DiagnosticType::CoolantTemp, temp + noise(rng));
+            auto an = gm.statusOf("Drf").anomalies;
+            drift = std::find(an.begin(), an.end(), "CoolantTemp: Sensor Drift") != an.end();
+        }
+        assert(drift);
+        assert(temp < 95); // caught well before crossing any fixed limit
+    }
+
+    // 16) Spikes and rate-of-change limits
+    {
+        GarageMonitor gm;
+        gm.addDiagnostic("Spk", DiagnosticType::RPM, 0);
+        gm.addDiagnostic("Spk", DiagnosticType::EngineLoad, 10);
+        std::mt19937 rng(11);
+        std::uniform_real_distribution<double> noise(-1.0, 1.0);
+        for (int i = 0; i < 100; ++i) gm.addDiagnostic("Spk", DiagnosticType::CoolantTemp, 90 + noise(rng));
+        gm.addDiagnostic("Spk", DiagnosticType::CoolantTemp, 102);
+        auto st = gm.statusOf("Spk");
+        assert(std::find(st.anomalies.begin(), st.anomalies.end(), "CoolantTemp: Abnormal Reading") != st.anomalies.end());
+        assert(std::find(st.anomalies.begin(), st.anomalies.end(), "CoolantTemp: Rapid Change") == st.anomalies.end());
+        gm.addDiagnostic("Spk", DiagnosticType::RPM, 5000);
+        st = gm.statusOf("Spk");
+        assert(std::find(st.anomalies.begin(), st.anomalies.end(), "RPM: Rapid Change") != st.anomalies.end());
+    }
+
+    // 17) A nan/inf reading is flagged but does not disable later detection
+    for (const char* bad : {"nan", "inf"}) {
+        GarageMonitor gm;
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<double> noise(-1.0, 1.0);
+        auto feed = [&](int n){
+            for (int i = 0; i < n; ++i) gm.addDiagnostic("Nan", DiagnosticType::CoolantTemp, 90 + noise(rng));
+        };
+        feed(100);
+        std::stringstream csv(std::string("Nan, CoolantTemp, ") + bad + "\n");
+        std::vector<std::string> errors;
+        assert(gm.loadCSV(csv, errors) == 1);
+        auto an = gm.statusOf("Nan").anomalies;
+        assert(an.size() == 1 && an[0] == "CoolantTemp: Invalid Reading");
+        feed(300);
+        gm.addDiagnostic("Nan", DiagnosticType::CoolantTemp, 118);
+        an = gm.statusOf("Nan").anomalies;
+        assert(std::find(an.begin(), an.end(), "CoolantTemp: Abnormal Reading") != an.end());
+    }
+
+    // 18) Partitioned mode matches the shared monitor on the same input
+    {
+        const char* rows =
+            "Car1, RPM, 6500\nCar1, CoolantTemp, 120\nCar1, EngineLoad, 95\n"
+            "Car2, EngineLoad, 95\nCar2, RPM, 4500\nCar2, CoolantTemp, 88\n"
+            "Car3, RPM, 2000\nCar3, EngineLoad, 10\nCar3, CoolantTemp, 90\n"
+            "Car4, RPM, 1000\nCar4, Bogus, 1\n";
+        GarageMonitor gm;
+        PartitionedMonitor pm(3);
+        std::stringstream a(rows), b(rows);
+        std::vector<std::string> errA, errB;
+        assert(gm.loadCSV(a, errA) == pm.loadCSV(b, errB));
+        assert(errA == errB);
+        std::stringstream outA, outB;
+        gm.printStatus(outA);
+        pm.printStatus(outB);
+        assert(outA.str() == outB.str());
+        assert(approx(*gm.averageScore(), *pm.averageScore()));
+        assert(pm.statusOf("Car4").alert == "Sensor Failure Detected");
+        assert(pm.hasCar("Car2") && !pm.hasCar("Car9"));
+        pm.addCar("Car9");
+        assert(pm.hasCar("Car9") && pm.statusOf("Car9").alert == "Sensor Failure Detected");
+        assert(pm.simulateRealTimeUpdates(50) >= 0);
+        assert(pm.averageScore().has_value());
+        assert(pm.flush() == 0); // nothing was dropped
+
+        // A task's exception reaches the caller and the workers keep running
+        bool threw = false;
+        try {
+            pm.forEachWorker([](unsigned i, GarageMonitor&){ if (i == 1) throw std::runtime_error("boom"); });
+        } catch (const std::runtime_error&) {
+            threw = true;
+        }
+        assert(threw);
+        assert(pm.hasCar("Car2"));
+
+        // Several producers and querying threads at once; each producer owns its cars
+        {
+            PartitionedMonitor multi(3);
+            GarageMonitor ref;
+            std::vector<std::thread> producers;
+            for (int t = 0; t < 3; ++t) {
+                producers.emplace_back([&multi, t]{
+                    std::string id = "P" + std::to_string(t);
+                    for (int i = 0; i < 200; ++i) {
+                        multi.addDiagnostic(id, DiagnosticType::RPM, 1000.0 + i * 10 + t);
+                        multi.addDiagnostic(id, DiagnosticType::EngineLoad, 20.0 + (i % 7));
+                        multi.addDiagnostic(id, DiagnosticType::CoolantTemp, 85.0 + (i % 5));
+                        if (i % 50 == 0) (void)multi.averageScore();
+                    }
+                    (void)multi.statusOf(id); // a producer's own updates are visible to it
+                });
+            }
+            for (auto& th : producers) th.join();
+            for (int t = 0; t < 3; ++t) {
+                std::string id = "P" + std::to_string(t);
+                for (int i = 0; i < 200; ++i) {
+                    ref.addDiagnostic(id, DiagnosticType::RPM, 1000.0 + i * 10 + t);
+                    ref.addDiagnostic(id, DiagnosticType::EngineLoad, 20.0 + (i % 7));
+                    ref.addDiagnostic(id, DiagnosticType::CoolantTemp, 85.0 + (i % 5));
+                }
+            }
+            assert(multi.flush() == 0);
+            auto want = ref.statuses(), got = multi.statuses();
+            assert(want.size() == got.size());
+            for (size_t i = 0; i < want.size(); ++i) {
+                assert(want[i].first == got[i].first && sameStatus(want[i].second, got[i].second));
+            }
+        }
+    }
+
+    // 19) Per-reading car state sits in buffers of whole cache lines
+    {
+        CacheAlignedVector<double> v(3);
+        assert(reinterpret_cast<std::uintptr_t>(v.data()) % CacheLineSize == 0);
+        Car car("Al");
+        car.set(ChannelRPM, 800.0);
+        assert(reinterpret_cast<std::uintptr_t>(car.slots().data()) % CacheLineSize == 0);
+        static_assert(sizeof(ChannelSlot) == CacheLineSize, "one reading, one cache line");
+        assert(car.slot(ChannelRPM) == &car.slots()[ChannelRPM]);
+        assert(car.slot(InvalidChannel) == nullptr);
+    }
+
     std::cout << "All tests passed.\n";
     return 0;
 }